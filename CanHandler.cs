@@ -19,6 +19,7 @@ namespace usb_bulk_2
         private volatile bool _isListening; // volatile for thread safety on this flag
 
         public event Action<CanMessage> CanMessageReceived;
+        public event Action<CanStatsSnapshot> CanStatsReceived; // PSoC aggregation modu snapshot paketleri
         public event Action<string, System.Drawing.Color?> LogMessageRequest; // Renamed for clarity
 
         private ulong _rxCanMessageCounter = 0;
@@ -146,7 +147,21 @@ namespace usb_bulk_2
 
                     if (success)
                     {
-                        if (bytesToRead >= 18) // PSoC sends 18-byte CAN messages
+                        // Aggregation mode: PSoC sends per-ID statistics snapshots (marker 0xC5, 4 + n*20 bytes).
+                        // 4 + n*20 never equals 18, so this cannot be confused with a raw CAN frame.
+                        if (CanStatsSnapshot.IsSnapshotPacket(buffer, bytesToRead))
+                        {
+                            CanStatsSnapshot snapshot = CanStatsSnapshot.FromPSoCByteArray(buffer, bytesToRead);
+                            if (snapshot != null)
+                            {
+                                CanStatsReceived?.Invoke(snapshot);
+                            }
+                            else
+                            {
+                                Log($"CAN Stats: Failed to parse {bytesToRead} byte snapshot. Data: {BitConverter.ToString(buffer, 0, bytesToRead)}", System.Drawing.Color.Orange);
+                            }
+                        }
+                        else if (bytesToRead >= 18) // PSoC sends 18-byte CAN messages
                         {
                             // Assuming PSoC sends one 18-byte message per USB_LoadInEP call for CAN.
                             // If multiple messages could be packed, a loop here would be needed.
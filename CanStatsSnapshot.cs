@@ -0,0 +1,113 @@
+﻿// CanStatsSnapshot.cs
+using System;
+using System.Collections.Generic;
+
+namespace usb_bulk_2
+{
+    // PSoC aggregation modunda EP6'dan gelen snapshot paketindeki tek bir CAN ID kaydı
+    public class CanStatsEntry
+    {
+        public uint Id { get; set; }
+        public bool IsExtended { get; set; }
+        public ushort Frames { get; set; }            // Interval içindeki frame sayısı
+        public ushort PeriodMinMs { get; set; }
+        public ushort PeriodMaxMs { get; set; }
+        public byte Length { get; set; }              // Son DLC
+        public byte Changes { get; set; }             // Bit 0: DLC değişti, Bit 1: payload değişti
+        public byte[] Data { get; private set; } = new byte[8]; // Son payload
+
+        // Kayıt tabloya eklendikten sonraki ilk frame'de PSoC min = 0xFFFF, max = 0 gönderir.
+        // Sonraki interval'lerde tek frame gelse bile periyot bir önceki frame'den ölçülür.
+        public bool HasPeriod => PeriodMinMs <= PeriodMaxMs;
+        public int JitterMs => HasPeriod ? PeriodMaxMs - PeriodMinMs : 0;
+        public bool DlcChanged => (Changes & CanStatsSnapshot.CHANGE_DLC) != 0;
+        public bool DataChanged => (Changes & CanStatsSnapshot.CHANGE_DATA) != 0;
+
+        public string IdToHexString()
+        {
+            return IsExtended ? $"{Id:X8}" : $"{Id:X3} (STD)";
+        }
+
+        public string DataToHexString()
+        {
+            int len = Math.Min((int)Length, 8);
+            return len == 0 ? string.Empty : BitConverter.ToString(Data, 0, len).Replace("-", " ");
+        }
+
+        public override string ToString()
+        {
+            string period = HasPeriod ? $"period {PeriodMinMs}..{PeriodMaxMs} ms (jitter {JitterMs} ms)" : "period -";
+            string changes = (DlcChanged ? " DLC*" : "") + (DataChanged ? " Data*" : "");
+            return $"ID {IdToHexString()} n={Frames} {period} DLC {Length} [{DataToHexString()}]{changes}";
+        }
+    }
+
+    // PSoC aggregation modu snapshot paketi: 4 byte başlık + n x 20 byte kayıt
+    public class CanStatsSnapshot
+    {
+        public const byte SNAPSHOT_MARKER = 0xC5;
+        public const int HEADER_LEN = 4;
+        public const int ENTRY_LEN = 20;
+
+        public const byte FLAG_LAST = 0x01;
+        public const byte FLAG_EVICTED = 0x02;
+        public const byte CHANGE_DLC = 0x01;
+        public const byte CHANGE_DATA = 0x02;
+
+        public DateTime UiTimestamp { get; set; }
+        public byte Sequence { get; set; }
+        public byte Flags { get; set; }
+        public List<CanStatsEntry> Entries { get; } = new List<CanStatsEntry>();
+
+        public bool IsLast => (Flags & FLAG_LAST) != 0;
+        public bool Evicted => (Flags & FLAG_EVICTED) != 0;
+
+        // Paket snapshot formatında mı (marker ve 4 + n*20 uzunluk)
+        public static bool IsSnapshotPacket(byte[] rawData, int length)
+        {
+            return rawData != null && length >= HEADER_LEN && length <= rawData.Length &&
+                   rawData[0] == SNAPSHOT_MARKER && (length - HEADER_LEN) % ENTRY_LEN == 0;
+        }
+
+        // PSoC'tan gelen ham snapshot paketini çözer, format uymazsa null döner
+        public static CanStatsSnapshot FromPSoCByteArray(byte[] rawData, int length)
+        {
+            if (!IsSnapshotPacket(rawData, length))
+                return null;
+
+            int count = rawData[2];
+            if (HEADER_LEN + count * ENTRY_LEN != length)
+                return null;
+
+            var snapshot = new CanStatsSnapshot
+            {
+                UiTimestamp = DateTime.Now,
+                Sequence = rawData[1],
+                Flags = rawData[3]
+            };
+
+            for (int i = 0; i < count; i++)
+            {
+                int offset = HEADER_LEN + i * ENTRY_LEN;
+                uint key = BitConverter.ToUInt32(rawData, offset);
+
+                var entry = new CanStatsEntry
+                {
+                    Id = key & 0x1FFFFFFF,
+                    IsExtended = (key & 0x80000000) != 0,
+                    Frames = BitConverter.ToUInt16(rawData, offset + 4),
+                    PeriodMinMs = BitConverter.ToUInt16(rawData, offset + 6),
+                    PeriodMaxMs = BitConverter.ToUInt16(rawData, offset + 8),
+                    Length = rawData[offset + 10],
+                    Changes = rawData[offset + 11]
+                };
+                Array.Copy(rawData, offset + 12, entry.Data, 0, 8);
+                if (entry.Length > 8) entry.Length = 8; // Güvenlik önlemi
+
+                snapshot.Entries.Add(entry);
+            }
+
+            return snapshot;
+        }
+    }
+}
\ No newline at end of file
@@ -104,6 +104,7 @@ namespace usb_bulk_2
                 cmbCommands.Items.Add(new CommandItem("Version", UsbPacket.CMD_VERSION));
                 cmbCommands.Items.Add(new CommandItem("USB String Echo", UsbPacket.CMD_ECHO_STRING));
                 cmbCommands.Items.Add(new CommandItem("UART String Echo", UsbPacket.CMD_UART_ECHO_STRING));
+                cmbCommands.Items.Add(new CommandItem("CAN Stats", UsbPacket.CMD_CAN_STATS));
                 if (cmbCommands.Items.Count > 0) cmbCommands.SelectedIndex = 0; // Eğer komut varsa, ilk komutu seçili hale getirir.
             }
             else
@@ -212,6 +213,7 @@ namespace usb_bulk_2
             _canHandler = new CanHandler(); // CanHandler nesnesini oluşturur.
             _canHandler.CanMessageReceived += HandleCanMessageFromCanHandler; // CanHandler'dan CAN mesajı alındığında HandleCanMessageFromCanHandler metodunu çağırır.
             _canHandler.LogMessageRequest += (msg, color) => LogMessage($"[CAN] {msg}", color); // CanHandler'dan log mesajı isteği geldiğinde ana log alanına yazar.
+            _canHandler.CanStatsReceived += HandleCanStatsFromCanHandler; // PSoC aggregation modu snapshot paketi geldiğinde HandleCanStatsFromCanHandler metodunu çağırır.
             btnSendCanMessage.Click += BtnSendCanMessageViaHandler_Click; // CAN mesajı gönderme butonuna tıklandığında BtnSendCanMessageViaHandler_Click metodunu çağırır.
         }
 
@@ -611,6 +613,16 @@ namespace usb_bulk_2
                 packetToSend.Data[0] = writeVal; // Parse edilen değeri paketin data alanına yazar.
                 packetToSend.DataLength = 1;     // Veri uzunluğunu 1 olarak ayarlar.
             }
+            // Eğer komut "CAN Stats" ise, aggregation modu açık/kapalı ve snapshot aralığını parse edip pakete ekler.
+            // Veri alanı boşsa sadece durum sorgulanır.
+            else if (selectedCmdItem.CommandId == UsbPacket.CMD_CAN_STATS && dataInput.Length > 0)
+            {
+                if (!TryParseCanStatsArgs(dataInput, out byte enable, out ushort intervalMs)) return; // Parse edilemezse çıkar.
+                packetToSend.Data[0] = enable;
+                packetToSend.Data[1] = (byte)(intervalMs & 0xFF);
+                packetToSend.Data[2] = (byte)(intervalMs >> 8);
+                packetToSend.DataLength = 3; // PSoC aralık için iki byte'ı birlikte bekler (0 = mevcut aralığı koru).
+            }
 
             LogMessage($"----- Sending USB Custom Command: {selectedCmdItem.Name} -----", Color.Indigo);
             UsbPacket response = SendUsbPacket(packetToSend); // Paketi gönderir ve yanıtı alır.
@@ -648,6 +660,36 @@ namespace usb_bulk_2
             }
             return true; // Başarılı parse.
         }
+        // "CAN Stats" komutu için girdiyi parse eder: "on [aralık_ms]", "off" veya "1 500" / "0".
+        // Aralık verilmezse 0 döner, PSoC bu durumda mevcut aralığı korur ("off" ayarlı aralığı sıfırlamaz).
+        private bool TryParseCanStatsArgs(string input, out byte enable, out ushort intervalMs)
+        {
+            enable = 0;
+            intervalMs = 0;
+            string[] parts = input.Split(new[] { ' ', ',', ';' }, StringSplitOptions.RemoveEmptyEntries);
+
+            if (parts.Length == 0 || parts.Length > 2)
+            {
+                MessageBox.Show("CAN Stats input: \"on [interval_ms]\" or \"off\". Example: on 500", "Input Error", MessageBoxButtons.OK, MessageBoxIcon.Error);
+                return false;
+            }
+
+            string mode = parts[0].ToLowerInvariant();
+            if (mode == "on" || mode == "1") enable = 1;
+            else if (mode == "off" || mode == "0") enable = 0;
+            else
+            {
+                MessageBox.Show("Invalid CAN Stats mode! Use on/off or 1/0.", "Input Error", MessageBoxButtons.OK, MessageBoxIcon.Error);
+                return false;
+            }
+
+            if (parts.Length == 2 && (!ushort.TryParse(parts[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out intervalMs) || intervalMs == 0))
+            {
+                MessageBox.Show("Invalid CAN Stats interval! Enter milliseconds (1-65535). Example: on 500", "Input Error", MessageBoxButtons.OK, MessageBoxIcon.Error);
+                return false;
+            }
+            return true; // Başarılı parse.
+        }
         #endregion
 
         #region USB Echo Logic (Detaylı Loglama)
@@ -970,6 +1012,30 @@ namespace usb_bulk_2
             }
         }
 
+        // CanHandler'dan aggregation modu snapshot paketi geldiğinde çağrılır.
+        // Paketteki her CAN ID kaydını UI thread'inde log alanına yazar.
+        private void HandleCanStatsFromCanHandler(CanStatsSnapshot snapshot)
+        {
+            if (this.IsHandleCreated && !this.IsDisposed)
+            {
+                this.BeginInvoke(new Action(() =>
+                {
+                    if (isCanUiPaused) return; // CAN UI güncellemeleri duraklatılmışsa snapshot'ı gösterme.
+
+                    string flags = (snapshot.IsLast ? " last" : "") + (snapshot.Evicted ? " evicted" : "");
+                    LogMessage($"[CAN Stats #{snapshot.Sequence}] {snapshot.Entries.Count} ID(s){flags}", canRxLogColor);
+                    foreach (CanStatsEntry entry in snapshot.Entries)
+                    {
+                        LogMessage($"[CAN Stats #{snapshot.Sequence}]   {entry}", canRxLogColor);
+                    }
+                    if (snapshot.Evicted && snapshot.IsLast) // Evicted flag'i snapshot'ın her paketinde gelir, bir kez uyar.
+                    {
+                        LogMessage($"[CAN Stats #{snapshot.Sequence}] PSoC stats table was full, least recently seen IDs were evicted.", errorLogColor);
+                    }
+                }));
+            }
+        }
+
         // Verilen CanMessage'ı belirtilen ListView'a ve renkte bir öğe olarak ekler.
         // ListView'daki öğe sayısını sınırlar ve yeni öğenin görünür olmasını sağlar (UI duraklatılmamışsa).
         private void AddCanMessageToUiListView(ListView listView, CanMessage message, Color itemColor)
@@ -13,6 +13,7 @@
 #define CMD_RESET          0x04
 #define CMD_VERSION        0x05
 #define CMD_ECHO_STRING    0x06
+#define CMD_CAN_STATS      0x07
 
 #define RESULT_OK          0x00
 #define RESULT_ERROR       0x01
@@ -0,0 +1,264 @@
+/*can_stats*/
+
+#include "can_stats.h"
+
+/* Aggregation modunda her frame yerine CAN ID başına istatistik tutulur  */
+/* ve belirli aralıklarla EP6 üzerinden snapshot olarak gönderilir.        */
+/* Tablo sabit boyutlu, linear probing kullanan open-addressing hash'tir. */
+/* Silme yapılmaz; tablo doluyken en uzun süredir görülmeyen kayıt        */
+/* yeni ID ile üzerine yazılır, böylece probe zincirleri bozulmaz.         */
+
+static CAN_Stats_Entry_t can_stats_table[CAN_STATS_TABLE_SIZE];
+
+static uint8 can_stats_enabled = 0;
+static uint16 can_stats_interval = CAN_STATS_DEFAULT_INTERVAL;
+static uint32 can_stats_last_snapshot = 0;
+static uint8 can_stats_evicted = 0;
+
+/* Snapshot gönderim durumu */
+static uint8 can_stats_exporting = 0;
+static uint16 can_stats_cursor = 0;
+static uint8 can_stats_sequence = 0;
+static uint8 can_stats_export_flags = 0;
+
+static uint16 CAN_Stats_Hash(uint32 key)
+{
+    /* Knuth multiplicative hash, 32-bit çarpımın üst bitleri kullanılır */
+    return (uint16)((key * 2654435761u) >> (32u - CAN_STATS_TABLE_BITS));
+}
+
+static void CAN_Stats_ClearInterval(CAN_Stats_Entry_t* entry)
+{
+    entry->frames = 0;
+    entry->periodMinMs = 0xFFFF;
+    entry->periodMaxMs = 0;
+    entry->changes = 0;
+}
+
+static void CAN_Stats_StoreFrame(CAN_Stats_Entry_t* entry, CAN_Message_t* msg, uint32 nowMs)
+{
+    uint8 i;
+
+    for (i = 0; i < 8; i++) {
+        entry->data[i] = msg->data[i];
+    }
+    entry->length = msg->length;
+    entry->lastSeenMs = nowMs;
+
+    if (entry->frames < 0xFFFF) {
+        entry->frames++;
+    }
+}
+
+void CAN_Stats_Init(void)
+{
+    uint16 i;
+
+    for (i = 0; i < CAN_STATS_TABLE_SIZE; i++) {
+        can_stats_table[i].used = 0;
+        can_stats_table[i].key = 0;
+        CAN_Stats_ClearInterval(&can_stats_table[i]);
+    }
+
+    can_stats_evicted = 0;
+    can_stats_exporting = 0;
+    can_stats_cursor = 0;
+}
+
+/* intervalMs = 0 mevcut aralığı korur; varsayılan sadece başlangıçta geçerlidir */
+void CAN_Stats_SetConfig(uint8 enabled, uint16 intervalMs, uint32 nowMs)
+{
+    if (intervalMs == 0) {
+        intervalMs = can_stats_interval;
+    } else if (intervalMs < CAN_STATS_MIN_INTERVAL) {
+        intervalMs = CAN_STATS_MIN_INTERVAL;
+    }
+
+    /* Mod yeni açılıyorsa tabloyu temizle */
+    if (enabled && !can_stats_enabled) {
+        CAN_Stats_Init();
+        can_stats_last_snapshot = nowMs;
+    }
+
+    can_stats_enabled = enabled ? 1 : 0;
+    can_stats_interval = intervalMs;
+}
+
+uint8 CAN_Stats_IsEnabled(void)
+{
+    return can_stats_enabled;
+}
+
+uint16 CAN_Stats_GetInterval(void)
+{
+    return can_stats_interval;
+}
+
+uint8 CAN_Stats_GetActiveCount(void)
+{
+    uint16 i;
+    uint8 count = 0;
+
+    for (i = 0; i < CAN_STATS_TABLE_SIZE; i++) {
+        if (can_stats_table[i].used) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void CAN_Stats_Update(CAN_Message_t* msg, uint32 nowMs)
+{
+    uint32 key = msg->id & 0x1FFFFFFFu;
+    uint16 home;
+    uint16 slot;
+    uint16 victim;
+    uint8 probe;
+    CAN_Stats_Entry_t* entry;
+
+    if (msg->properties & 0x01) { /* Bit 0: IDE (1 = Extended) */
+        key |= CAN_STATS_KEY_IDE;
+    }
+
+    home = CAN_Stats_Hash(key);
+    victim = home;
+
+    for (probe = 0; probe < CAN_STATS_MAX_PROBE; probe++) {
+        slot = (home + probe) & (CAN_STATS_TABLE_SIZE - 1u);
+        entry = &can_stats_table[slot];
+
+        if (!entry->used) {
+            /* Boş slot, yeni ID */
+            entry->used = 1;
+            entry->key = key;
+            CAN_Stats_ClearInterval(entry);
+            CAN_Stats_StoreFrame(entry, msg, nowMs);
+            return;
+        }
+
+        if (entry->key == key) {
+            uint32 period = nowMs - entry->lastSeenMs;
+            uint8 len = (msg->length < 8) ? msg->length : 8;
+            uint8 i;
+
+            if (period > 0xFFFF) {
+                period = 0xFFFF;
+            }
+            if (period < entry->periodMinMs) {
+                entry->periodMinMs = (uint16)period;
+            }
+            if (period > entry->periodMaxMs) {
+                entry->periodMaxMs = (uint16)period;
+            }
+
+            if (msg->length != entry->length) {
+                entry->changes |= CAN_STATS_CHANGE_DLC;
+            }
+            for (i = 0; i < len; i++) {
+                if (msg->data[i] != entry->data[i]) {
+                    entry->changes |= CAN_STATS_CHANGE_DATA;
+                    break;
+                }
+            }
+
+            CAN_Stats_StoreFrame(entry, msg, nowMs);
+            return;
+        }
+
+        /* En uzun süredir görülmeyen kaydı aday olarak sakla */
+        if ((uint32)(nowMs - entry->lastSeenMs) > (uint32)(nowMs - can_stats_table[victim].lastSeenMs)) {
+            victim = slot;
+        }
+    }
+
+    /* Probe penceresi dolu, en eski kaydın yerine yaz */
+    entry = &can_stats_table[victim];
+    entry->key = key;
+    CAN_Stats_ClearInterval(entry);
+    CAN_Stats_StoreFrame(entry, msg, nowMs);
+    can_stats_evicted = 1;
+}
+
+/* Snapshot paketi formatı (little-endian):                                */
+/* [0] marker 0xC5, [1] sıra no, [2] kayıt sayısı, [3] flag'ler           */
+/* Her kayıt 20 byte: [0..3] ID (bit 31 = extended), [4..5] frame sayısı, */
+/* [6..7] min periyot ms, [8..9] max periyot ms, [10] DLC,                 */
+/* [11] değişiklik flag'leri, [12..19] son payload                         */
+/* Periyot, ID'nin bir önceki frame'inden ölçülür; önceki frame başka bir */
+/* interval'de olabilir, yani interval'de tek frame gelse de periyot var. */
+/* Sadece kayıt tabloya eklendikten (boş ya da tahliye edilen slot) sonra */
+/* ilk frame'i içeren interval'de ölçüm yoksa min 0xFFFF, max 0 gönderilir;*/
+/* min > max "periyot yok" demektir. Aynı ms içindeki iki frame gerçek    */
+/* periyot 0 olarak gönderilir.                                           */
+uint16 CAN_Stats_Prepare_USB_Snapshot(uint8* usb_data, uint32 nowMs)
+{
+    uint8 count = 0;
+    uint8 i;
+    uint8* p;
+    CAN_Stats_Entry_t* entry;
+
+    if (!can_stats_enabled) {
+        return 0;
+    }
+
+    if (!can_stats_exporting) {
+        if ((uint32)(nowMs - can_stats_last_snapshot) < can_stats_interval) {
+            return 0; /* Henüz zamanı gelmedi */
+        }
+        can_stats_last_snapshot = nowMs;
+        can_stats_exporting = 1;
+        can_stats_cursor = 0;
+        can_stats_sequence++;
+        can_stats_export_flags = can_stats_evicted ? CAN_STATS_FLAG_EVICTED : 0;
+        can_stats_evicted = 0;
+    }
+
+    p = &usb_data[CAN_STATS_HEADER_LEN];
+
+    while (can_stats_cursor < CAN_STATS_TABLE_SIZE && count < CAN_STATS_ENTRIES_PER_PKT) {
+        entry = &can_stats_table[can_stats_cursor++];
+
+        if (!entry->used || entry->frames == 0) {
+            continue;
+        }
+
+        p[0] = (uint8)(entry->key & 0xFF);
+        p[1] = (uint8)((entry->key >> 8) & 0xFF);
+        p[2] = (uint8)((entry->key >> 16) & 0xFF);
+        p[3] = (uint8)((entry->key >> 24) & 0xFF);
+        p[4] = (uint8)(entry->frames & 0xFF);
+        p[5] = (uint8)((entry->frames >> 8) & 0xFF);
+        p[6] = (uint8)(entry->periodMinMs & 0xFF);
+        p[7] = (uint8)((entry->periodMinMs >> 8) & 0xFF);
+        p[8] = (uint8)(entry->periodMaxMs & 0xFF);
+        p[9] = (uint8)((entry->periodMaxMs >> 8) & 0xFF);
+        p[10] = entry->length;
+        p[11] = entry->changes;
+        for (i = 0; i < 8; i++) {
+            p[12 + i] = entry->data[i];
+        }
+
+        CAN_Stats_ClearInterval(entry);
+        p += CAN_STATS_ENTRY_LEN;
+        count++;
+    }
+
+    /* Kalan slotlarda gönderilecek kayıt yoksa bu paket son pakettir */
+    while (can_stats_cursor < CAN_STATS_TABLE_SIZE &&
+           (!can_stats_table[can_stats_cursor].used || can_stats_table[can_stats_cursor].frames == 0)) {
+        can_stats_cursor++;
+    }
+
+    usb_data[0] = CAN_STATS_SNAPSHOT_MARKER;
+    usb_data[1] = can_stats_sequence;
+    usb_data[2] = count;
+    usb_data[3] = can_stats_export_flags;
+
+    if (can_stats_cursor >= CAN_STATS_TABLE_SIZE) {
+        usb_data[3] |= CAN_STATS_FLAG_LAST;
+        can_stats_exporting = 0;
+    }
+
+    return CAN_STATS_HEADER_LEN + (uint16)count * CAN_STATS_ENTRY_LEN;
+}
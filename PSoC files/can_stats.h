@@ -0,0 +1,55 @@
+#ifndef CAN_STATS_H
+#define CAN_STATS_H
+
+#include "can_help.h"
+
+/* Tablo kapasitesi 2'nin kuvveti: 2^CAN_STATS_TABLE_BITS slot */
+#ifndef CAN_STATS_TABLE_BITS
+#define CAN_STATS_TABLE_BITS        6u
+#endif
+#if CAN_STATS_TABLE_BITS > 7
+#error "CAN_STATS_TABLE_BITS en fazla 7 olabilir (aktif kayıt sayısı uint8)"
+#endif
+#define CAN_STATS_TABLE_SIZE        (1u << CAN_STATS_TABLE_BITS)
+#define CAN_STATS_MAX_PROBE         8u     /* Bir ID için bakılan en fazla slot sayısı */
+
+#define CAN_STATS_DEFAULT_INTERVAL  1000u  /* ms */
+#define CAN_STATS_MIN_INTERVAL      10u    /* ms */
+
+/* EP6 snapshot paketi: 4 byte başlık + 3 x 20 byte kayıt = 64 byte */
+#define CAN_STATS_SNAPSHOT_MARKER   0xC5
+#define CAN_STATS_HEADER_LEN        4u
+#define CAN_STATS_ENTRY_LEN         20u
+#define CAN_STATS_ENTRIES_PER_PKT   3u
+
+/* Snapshot başlığı flag'leri (byte 3) */
+#define CAN_STATS_FLAG_LAST         0x01   /* Snapshot'ın son paketi */
+#define CAN_STATS_FLAG_EVICTED      0x02   /* Son snapshot'tan beri tablodan kayıt atıldı */
+
+/* Kayıt değişiklik flag'leri (entry byte 11) */
+#define CAN_STATS_CHANGE_DLC        0x01
+#define CAN_STATS_CHANGE_DATA       0x02
+
+#define CAN_STATS_KEY_IDE           0x80000000u /* Anahtarda extended ID işareti */
+
+typedef struct {
+    uint32 key;          /* CAN ID, extended ise bit 31 set */
+    uint32 lastSeenMs;
+    uint16 frames;       /* Interval içindeki frame sayısı (doyumlu) */
+    uint16 periodMinMs;
+    uint16 periodMaxMs;
+    uint8 data[8];       /* Son payload */
+    uint8 length;        /* Son DLC */
+    uint8 changes;       /* Interval içindeki DLC/payload değişiklikleri */
+    uint8 used;
+} CAN_Stats_Entry_t;
+
+void CAN_Stats_Init(void);
+void CAN_Stats_SetConfig(uint8 enabled, uint16 intervalMs, uint32 nowMs);
+uint8 CAN_Stats_IsEnabled(void);
+uint16 CAN_Stats_GetInterval(void);
+uint8 CAN_Stats_GetActiveCount(void);
+void CAN_Stats_Update(CAN_Message_t* msg, uint32 nowMs);
+uint16 CAN_Stats_Prepare_USB_Snapshot(uint8* usb_data, uint32 nowMs);
+
+#endif /* CAN_STATS_H */
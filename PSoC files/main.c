@@ -2,6 +2,7 @@
 #include <project.h>
 #include "UsbPacket.h" 
 #include "can_help.h"
+#include "can_stats.h"
 
 /* Buffer boyutları */
 #define CUSTOM_BULK_BUFFER_LEN 64
@@ -32,6 +33,13 @@ const uint8 DEVICE_VERSION[3] = {1, 0, 0};
 uint8 deviceStatus = 0x00;
 uint32 packetCounter = 0;
 
+/* SysTick ile artan ms sayacı (CAN istatistik periyotları için) */
+volatile uint32 systemTickMs = 0;
+
+void SysTick_Callback(void) {
+    systemTickMs++;
+}
+
 
 // Custom Bulk Fonksiyonları -----
 void ProcessPacket() {
@@ -96,6 +104,29 @@ void ProcessPacket() {
                 responseLen = 1;
             }
             break;
+        case CMD_CAN_STATS:
+            /* data[0]: 1 = aggregation modu açık, data[1..2]: snapshot aralığı (ms)   */
+            /* Veri yoksa sadece durum döner; aralık verilecekse iki byte da gerekli */
+            /* Aralık 0 ya da 1 byte'lık payload mevcut aralığı değiştirmez           */
+            if (rxPacket.dataLength == 2) {
+                responseData[0] = RESULT_ERROR;
+                responseLen = 1;
+                break;
+            }
+            if (rxPacket.dataLength > 0) {
+                uint16 interval = 0;
+                if (rxPacket.dataLength > 2) {
+                    interval = (uint16)rxPacket.data[1] | ((uint16)rxPacket.data[2] << 8);
+                }
+                CAN_Stats_SetConfig(rxPacket.data[0], interval, systemTickMs);
+            }
+            responseData[0] = RESULT_OK;
+            responseData[1] = CAN_Stats_IsEnabled();
+            responseData[2] = (uint8)(CAN_Stats_GetInterval() & 0xFF);
+            responseData[3] = (uint8)((CAN_Stats_GetInterval() >> 8) & 0xFF);
+            responseData[4] = CAN_Stats_GetActiveCount();
+            responseLen = 5;
+            break;
         default:
             responseData[0] = RESULT_INVALID_CMD;
             responseLen = 1;
@@ -177,6 +208,11 @@ int main() {
     CyIntSetVector(CAN_ISR_NUMBER, CAN_ISR_Handler);
     CyIntEnable(CAN_ISR_NUMBER);
     
+    /* 1 ms SysTick, CAN istatistik zaman damgası için */
+    CySysTickStart();
+    CySysTickSetCallback(0, SysTick_Callback);
+    CAN_Stats_Init();
+    
 
     for(;;) {
         /* Bulk Transfer */
@@ -206,11 +242,24 @@ int main() {
         
         /* CAN'dan mesaj alma ve USB'ye gönderme */
         if (CAN_Receive_Message(&can_rx_message)) {
-            /* CAN mesajını USB formatına dönüştür */
-            uint16 usb_msg_len = CAN_Prepare_USB_Message(&can_rx_message, can_inBuffer);
-            
-            /* Veriyi host'a gönder - EP6 CAN bulk IN endpoint */
-            USB_LoadInEP(6, can_inBuffer, usb_msg_len);
+            if (CAN_Stats_IsEnabled()) {
+                /* Aggregation modu: frame'i gönderme, sadece istatistiği güncelle */
+                CAN_Stats_Update(&can_rx_message, systemTickMs);
+            } else {
+                /* CAN mesajını USB formatına dönüştür */
+                uint16 usb_msg_len = CAN_Prepare_USB_Message(&can_rx_message, can_inBuffer);
+                
+                /* Veriyi host'a gönder - EP6 CAN bulk IN endpoint */
+                USB_LoadInEP(6, can_inBuffer, usb_msg_len);
+            }
+        }
+        
+        /* Aggregation modunda snapshot'ı EP6 boşaldıkça paket paket gönder */
+        if (CAN_Stats_IsEnabled() && USB_GetEPState(6) == USB_IN_BUFFER_EMPTY) {
+            uint16 snapshot_len = CAN_Stats_Prepare_USB_Snapshot(can_inBuffer, systemTickMs);
+            if (snapshot_len > 0) {
+                USB_LoadInEP(6, can_inBuffer, snapshot_len);
+            }
         }
 
         /* USB UART haberleşme */
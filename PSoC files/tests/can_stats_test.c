@@ -0,0 +1,357 @@
+/*can_stats host testleri*/
+
+#include <stdio.h>
+#include <string.h>
+#include "can_stats.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+/* Snapshot'tan çözülmüş kayıt */
+typedef struct {
+    uint32 key;
+    uint16 frames;
+    uint16 periodMin;
+    uint16 periodMax;
+    uint8 length;
+    uint8 changes;
+} Entry_t;
+
+static Entry_t entries[CAN_STATS_TABLE_SIZE];
+static uint8 entryCount;
+static uint8 packetCount;
+static uint8 lastFlagCount;
+static uint8 lastFlagOnFinal;
+static uint8 snapshotFlags;
+
+static uint32 now = 0;
+
+static uint16 Hash(uint32 key)
+{
+    return (uint16)((key * 2654435761u) >> (32u - CAN_STATS_TABLE_BITS));
+}
+
+static void Reset(void)
+{
+    CAN_Stats_SetConfig(0, CAN_STATS_MIN_INTERVAL, now);
+    CAN_Stats_SetConfig(1, CAN_STATS_MIN_INTERVAL, now);
+}
+
+static void Feed(uint32 id, uint8 extended, uint8 length, uint8 firstByte)
+{
+    CAN_Message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.id = id;
+    msg.length = length;
+    msg.data[0] = firstByte;
+    msg.properties = extended ? 0x01 : 0x00;
+    CAN_Stats_Update(&msg, now);
+}
+
+/* Interval'i doldurup bir snapshot'ın tüm paketlerini çözer */
+static void Export(void)
+{
+    uint8 buf[64];
+    uint16 len;
+    uint8 i;
+
+    entryCount = 0;
+    packetCount = 0;
+    lastFlagCount = 0;
+    lastFlagOnFinal = 0;
+    snapshotFlags = 0;
+    now += CAN_STATS_MIN_INTERVAL;
+
+    do {
+        len = CAN_Stats_Prepare_USB_Snapshot(buf, now);
+        if (len == 0) {
+            break;
+        }
+        CHECK(buf[0] == CAN_STATS_SNAPSHOT_MARKER);
+        CHECK(len == CAN_STATS_HEADER_LEN + buf[2] * CAN_STATS_ENTRY_LEN);
+        packetCount++;
+        snapshotFlags |= buf[3] & CAN_STATS_FLAG_EVICTED;
+
+        for (i = 0; i < buf[2]; i++) {
+            uint8* p = &buf[CAN_STATS_HEADER_LEN + i * CAN_STATS_ENTRY_LEN];
+            Entry_t* e = &entries[entryCount++];
+            e->key = (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+            e->frames = (uint16)(p[4] | (p[5] << 8));
+            e->periodMin = (uint16)(p[6] | (p[7] << 8));
+            e->periodMax = (uint16)(p[8] | (p[9] << 8));
+            e->length = p[10];
+            e->changes = p[11];
+        }
+
+        if (buf[3] & CAN_STATS_FLAG_LAST) {
+            lastFlagCount++;
+            lastFlagOnFinal = 1;
+        }
+    } while (!(buf[3] & CAN_STATS_FLAG_LAST) && packetCount < 64);
+}
+
+static Entry_t* Find(uint32 key)
+{
+    uint8 i;
+    for (i = 0; i < entryCount; i++) {
+        if (entries[i].key == key) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* Aynı home slot'a düşen n adet standart ID bulur */
+static void FindCollidingIds(uint16 home, uint32* ids, uint8 n)
+{
+    uint32 id;
+    uint8 found = 0;
+    for (id = 0; id <= 0x7FF && found < n; id++) {
+        if (Hash(id) == home) {
+            ids[found++] = id;
+        }
+    }
+    CHECK(found == n);
+}
+
+static void Test_FillAllSlots(void)
+{
+    uint16 slot;
+    uint32 id;
+
+    printf("fill all slots\n");
+    Reset();
+
+    /* Her home slot için bir ID: probing olmadan tablo tam dolar */
+    for (slot = 0; slot < CAN_STATS_TABLE_SIZE; slot++) {
+        for (id = 0; id <= 0x7FF; id++) {
+            if (Hash(id) == slot) {
+                Feed(id, 0, 8, 0);
+                break;
+            }
+        }
+    }
+
+    CHECK(CAN_Stats_GetActiveCount() == CAN_STATS_TABLE_SIZE);
+    Export();
+    CHECK(entryCount == CAN_STATS_TABLE_SIZE);
+    CHECK(snapshotFlags == 0);
+}
+
+static void Test_MultiPacketLastFlag(void)
+{
+    uint32 id;
+
+    printf("multi-packet export\n");
+    Reset();
+
+    for (id = 0; id < 200; id++) {
+        Feed(id, 0, 8, 0);
+        now++;
+    }
+    CHECK(CAN_Stats_GetActiveCount() == CAN_STATS_TABLE_SIZE);
+
+    Export();
+    CHECK(entryCount == CAN_STATS_TABLE_SIZE);
+    CHECK(packetCount == (CAN_STATS_TABLE_SIZE + CAN_STATS_ENTRIES_PER_PKT - 1) / CAN_STATS_ENTRIES_PER_PKT);
+    CHECK(lastFlagCount == 1);
+    CHECK(lastFlagOnFinal);
+
+    /* Yeni frame yoksa sadece başlıktan oluşan tek paket gider */
+    Export();
+    CHECK(packetCount == 1);
+    CHECK(entryCount == 0);
+    CHECK(lastFlagCount == 1);
+}
+
+static void Test_ProbeWindowEviction(void)
+{
+    uint32 ids[CAN_STATS_MAX_PROBE + 2];
+    uint8 i;
+
+    printf("probe window eviction\n");
+    Reset();
+    FindCollidingIds(5, ids, CAN_STATS_MAX_PROBE + 2);
+
+    /* Pencereyi doldur: ids[0..7] slot 5..12 */
+    for (i = 0; i < CAN_STATS_MAX_PROBE; i++) {
+        Feed(ids[i], 0, 8, 0);
+        now++;
+    }
+    /* ids[0] tekrar görülür, en eski kayıt artık ids[1] */
+    Feed(ids[0], 0, 8, 0);
+    now++;
+
+    Feed(ids[CAN_STATS_MAX_PROBE], 0, 8, 0);
+    CHECK(CAN_Stats_GetActiveCount() == CAN_STATS_MAX_PROBE);
+
+    Export();
+    CHECK(Find(ids[1]) == NULL);
+    CHECK(Find(ids[0]) != NULL);
+    CHECK(Find(ids[CAN_STATS_MAX_PROBE]) != NULL);
+    CHECK(snapshotFlags & CAN_STATS_FLAG_EVICTED);
+
+    /* Bir sonraki snapshot'ta evicted flag'i temizlenmiş olmalı */
+    Feed(ids[0], 0, 8, 0);
+    Export();
+    CHECK((snapshotFlags & CAN_STATS_FLAG_EVICTED) == 0);
+}
+
+static void Test_KeyFoundAfterNeighbourEviction(void)
+{
+    uint32 ids[CAN_STATS_MAX_PROBE + 2];
+    uint8 i;
+    Entry_t* e;
+
+    printf("key found after neighbour eviction\n");
+    Reset();
+    FindCollidingIds(20, ids, CAN_STATS_MAX_PROBE + 2);
+
+    for (i = 0; i < CAN_STATS_MAX_PROBE; i++) {
+        Feed(ids[i], 0, 8, 0);
+        now++;
+    }
+    /* ids[7] hariç hepsi tekrar görülür; ids[7] pencerenin sonunda kalır */
+    for (i = 0; i < CAN_STATS_MAX_PROBE - 1; i++) {
+        Feed(ids[i], 0, 8, 0);
+    }
+    now++;
+
+    /* İki yeni ID, ids[7]'nin komşularını sırayla tahliye eder */
+    Feed(ids[CAN_STATS_MAX_PROBE], 0, 8, 0);
+    now++;
+    Feed(ids[CAN_STATS_MAX_PROBE + 1], 0, 8, 0);
+    now++;
+    CHECK(CAN_Stats_GetActiveCount() == CAN_STATS_MAX_PROBE);
+
+    /* İlk tahliye ids[7]'yi (slot 27), ikincisi ids[0]'ı (slot 20) alır. */
+    /* ids[3] probe zincirinde tahliye edilen slot 20'nin arkasındadır.   */
+    Feed(ids[3], 0, 8, 0);
+    CHECK(CAN_Stats_GetActiveCount() == CAN_STATS_MAX_PROBE);
+
+    Export();
+    e = Find(ids[3]);
+    CHECK(e != NULL);
+    if (e != NULL) {
+        CHECK(e->frames == 3);
+        CHECK(e->periodMin <= e->periodMax);
+    }
+    CHECK(Find(ids[0]) == NULL);
+    CHECK(Find(ids[CAN_STATS_MAX_PROBE - 1]) == NULL);
+    CHECK(Find(ids[CAN_STATS_MAX_PROBE]) != NULL);
+    CHECK(Find(ids[CAN_STATS_MAX_PROBE + 1]) != NULL);
+}
+
+static void Test_StandardVsExtended(void)
+{
+    Entry_t* e;
+
+    printf("standard vs extended ID\n");
+    Reset();
+
+    Feed(0x123, 0, 2, 0xAA);
+    Feed(0x123, 1, 4, 0xBB);
+    CHECK(CAN_Stats_GetActiveCount() == 2);
+
+    Export();
+    e = Find(0x123);
+    CHECK(e != NULL && e->length == 2 && e->frames == 1);
+    e = Find(0x123 | CAN_STATS_KEY_IDE);
+    CHECK(e != NULL && e->length == 4 && e->frames == 1);
+}
+
+static void Test_PeriodAndChanges(void)
+{
+    Entry_t* e;
+
+    printf("period and change tracking\n");
+    Reset();
+
+    /* Tabloya eklendikten sonraki ilk frame: periyot yok, min > max */
+    Feed(0x100, 0, 8, 1);
+    Export();
+    e = Find(0x100);
+    CHECK(e != NULL && e->periodMin == 0xFFFF && e->periodMax == 0);
+
+    /* Aynı ms içinde iki frame: gerçek periyot 0 */
+    Feed(0x100, 0, 8, 1);
+    Feed(0x100, 0, 8, 1);
+    Export();
+    e = Find(0x100);
+    CHECK(e != NULL && e->frames == 2 && e->periodMin == 0 && e->changes == 0);
+
+    now += 5;
+    Feed(0x100, 0, 4, 2);
+    Export();
+    e = Find(0x100);
+    CHECK(e != NULL && e->changes == (CAN_STATS_CHANGE_DLC | CAN_STATS_CHANGE_DATA));
+}
+
+static void Test_SingleFramePeriodAcrossIntervals(void)
+{
+    Entry_t* e;
+    uint32 firstSeen;
+
+    printf("single frame period across intervals\n");
+    Reset();
+
+    /* Interval'den uzun periyotlu ID (ör. heartbeat) */
+    firstSeen = now;
+    Feed(0x300, 0, 8, 0);
+    Export();
+    e = Find(0x300);
+    CHECK(e != NULL && e->frames == 1 && e->periodMin > e->periodMax);
+
+    now += 37;
+    Feed(0x300, 0, 8, 0);
+    Export();
+    e = Find(0x300);
+    CHECK(e != NULL && e->frames == 1);
+    if (e != NULL) {
+        CHECK(e->periodMin == (uint16)(now - CAN_STATS_MIN_INTERVAL - firstSeen));
+        CHECK(e->periodMin == e->periodMax);
+    }
+}
+
+static void Test_IntervalKeptWhenZero(void)
+{
+    printf("interval kept when zero\n");
+    Reset();
+
+    CAN_Stats_SetConfig(1, 500, now);
+    CHECK(CAN_Stats_GetInterval() == 500);
+
+    /* "off" ya da 1 byte'lık payload aralık olarak 0 gönderir */
+    CAN_Stats_SetConfig(0, 0, now);
+    CHECK(!CAN_Stats_IsEnabled());
+    CHECK(CAN_Stats_GetInterval() == 500);
+
+    CAN_Stats_SetConfig(1, 0, now);
+    CHECK(CAN_Stats_IsEnabled());
+    CHECK(CAN_Stats_GetInterval() == 500);
+}
+
+int main(void)
+{
+    Test_FillAllSlots();
+    Test_MultiPacketLastFlag();
+    Test_ProbeWindowEviction();
+    Test_KeyFoundAfterNeighbourEviction();
+    Test_StandardVsExtended();
+    Test_PeriodAndChanges();
+    Test_SingleFramePeriodAcrossIntervals();
+    Test_IntervalKeptWhenZero();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,13 @@
+/* PSoC Creator'ın ürettiği project.h yerine host testleri için minimal stub */
+#ifndef PROJECT_H_STUB
+#define PROJECT_H_STUB
+
+#include <stdint.h>
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+
+#define CY_ISR_PROTO(FuncName) void FuncName(void)
+
+#endif /* PROJECT_H_STUB */
@@ -17,6 +17,7 @@ namespace usb_bulk_2
         public const byte CMD_RESET = 0x04;
         public const byte CMD_VERSION = 0x05;
         public const byte CMD_ECHO_STRING = 0x06;
+        public const byte CMD_CAN_STATS = 0x07; // CAN ID istatistik (aggregation) modu ayarı
         public const byte CMD_UART_ECHO_STRING = 0xF0; // UART Echo için özel komut ID'si (UI için)
 
 
@@ -147,6 +148,7 @@ namespace usb_bulk_2
                 case CMD_VERSION: return "Version";
                 case CMD_ECHO_STRING: return "USB String Echo"; // Adı daha açıklayıcı hale getirildi
                 case CMD_UART_ECHO_STRING: return "UART String Echo";
+                case CMD_CAN_STATS: return "CAN Stats";
                 default: return $"Bilinmeyen (0x{commandId:X2})";
             }
         }
@@ -207,6 +209,15 @@ namespace usb_bulk_2
                         }
                         break;
 
+                    case CMD_CAN_STATS:
+                        if (DataLength > 4)
+                        {
+                            sb.AppendLine($"Aggregation: {(Data[1] != 0 ? "On" : "Off")}");
+                            sb.AppendLine($"Interval: {Data[2] | (Data[3] << 8)} ms");
+                            sb.AppendLine($"Active IDs: {Data[4]}");
+                        }
+                        break;
+
                     case CMD_ECHO_STRING: // USB Echo için
                         if (DataLength > 1)
                         {